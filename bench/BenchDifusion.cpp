@@ -0,0 +1,215 @@
+#include "DifusorMensajes.h"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+// Resultado de una corrida del benchmark
+struct Resultado {
+    size_t envios;  // Llamadas a send realizadas por el difusor
+    size_t lotes;  // Lotes despachados
+    double segundos;  // Tiempo hasta que todos los destinatarios recibieron todo
+    double latenciaPromedio;  // Microsegundos promedio entre encolar y recibir un mensaje
+    double latenciaMaxima;  // Microsegundos máximos entre encolar y recibir un mensaje
+    bool ordenCorrecto;  // Todo llegó a tiempo, cada remitente en orden y nadie recibió sus propios mensajes
+};
+
+// Tiempo máximo que espera el lector antes de dar la corrida por fallida
+const std::chrono::seconds plazoLector(30);
+
+// Marca de tiempo en microsegundos; remitentes y lector comparten el mismo reloj
+long long ahoraMicrosegundos() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Ejecuta una difusión entre usuarios simulados con pares de sockets. Con pausa cero
+// cada usuario envía su ráfaga de golpe; con pausa, espera entre mensajes para que
+// la ventana llegue a agotarse antes que el límite de bytes
+Resultado ejecutar(int ventanaMicrosegundos, size_t limiteBytes, int numUsuarios, int mensajesPorUsuario,
+                   int pausaMicrosegundos) {
+    std::vector<int> servidor(numUsuarios), cliente(numUsuarios);
+    for (int i = 0; i < numUsuarios; ++i) {
+        int par[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, par) == -1) {
+            std::cerr << "Error al crear el par de sockets.\n";
+            std::exit(1);
+        }
+        servidor[i] = par[0];
+        cliente[i] = par[1];
+    }
+
+    // Cada usuario debe recibir los mensajes de todos los demás
+    size_t esperadoPorUsuario = static_cast<size_t>(numUsuarios - 1) * mensajesPorUsuario;
+    std::vector<std::string> recibido(numUsuarios);
+    bool ordenCorrecto = true;
+    long long latenciaTotal = 0;
+    long long latenciaMaxima = 0;
+    size_t mensajesMedidos = 0;
+
+    // Hilo que vacía los sockets de los clientes y valida el orden por remitente.
+    // Si el difusor pierde o duplica datos, el plazo evita que la corrida se cuelgue
+    std::thread lector([&]() {
+        auto plazo = std::chrono::steady_clock::now() + plazoLector;
+        std::vector<std::vector<int>> ultimo(numUsuarios, std::vector<int>(numUsuarios, -1));
+        std::vector<size_t> lineas(numUsuarios, 0);
+        std::vector<pollfd> fds(numUsuarios);
+        for (int i = 0; i < numUsuarios; ++i) {
+            fds[i].fd = cliente[i];
+            fds[i].events = POLLIN;
+        }
+        size_t completos = 0;
+        char buffer[65536];
+        while (completos < static_cast<size_t>(numUsuarios)) {
+            if (std::chrono::steady_clock::now() >= plazo) {
+                std::cerr << "El lector no recibió todos los mensajes dentro del plazo.\n";
+                ordenCorrecto = false;
+                // Cierra los clientes para que los envíos pendientes fallen en lugar de bloquearse
+                for (int i = 0; i < numUsuarios; ++i) {
+                    shutdown(cliente[i], SHUT_RDWR);
+                }
+                break;
+            }
+            poll(fds.data(), fds.size(), 100);
+            for (int i = 0; i < numUsuarios; ++i) {
+                if (!(fds[i].revents & POLLIN)) {
+                    continue;
+                }
+                ssize_t bytes = recv(cliente[i], buffer, sizeof(buffer), 0);
+                if (bytes <= 0) {
+                    continue;
+                }
+                recibido[i].append(buffer, bytes);
+                long long llegada = ahoraMicrosegundos();
+                // Recorre las líneas completas y descarta lo procesado de una sola vez,
+                // para que el lector no sea el cuello de botella de la medición
+                size_t inicioLinea = 0, fin;
+                while ((fin = recibido[i].find('\n', inicioLinea)) != std::string::npos) {
+                    const char* linea = recibido[i].c_str() + inicioLinea;
+                    inicioLinea = fin + 1;
+                    char* resto;
+                    long remitente = std::strtol(linea, &resto, 10);
+                    bool valida = resto != linea && *resto == ':';
+                    const char* campo = resto + 1;
+                    long secuencia = valida ? std::strtol(campo, &resto, 10) : -1;
+                    valida = valida && resto != campo && *resto == ':';
+                    campo = resto + 1;
+                    long long encolado = valida ? std::strtoll(campo, &resto, 10) : 0;
+                    valida = valida && resto != campo && *resto == '\n';
+                    // Una línea corrupta no puede usarse como índice
+                    if (!valida || remitente < 0 || remitente >= numUsuarios) {
+                        ordenCorrecto = false;
+                        continue;
+                    }
+                    if (remitente == i || secuencia != ultimo[i][remitente] + 1) {
+                        ordenCorrecto = false;
+                    }
+                    ultimo[i][remitente] = secuencia;
+                    latenciaTotal += llegada - encolado;
+                    latenciaMaxima = std::max(latenciaMaxima, llegada - encolado);
+                    mensajesMedidos++;
+                    if (++lineas[i] == esperadoPorUsuario) {
+                        completos++;
+                    }
+                }
+                recibido[i].erase(0, inicioLinea);
+            }
+        }
+    });
+
+    auto inicio = std::chrono::steady_clock::now();
+    Resultado resultado;
+    {
+        DifusorMensajes difusor(std::chrono::microseconds(ventanaMicrosegundos), limiteBytes,
+                                [&servidor](const DifusorMensajes::Destino& destino) {
+                                    for (size_t i = 0; i < servidor.size(); ++i) {
+                                        destino(static_cast<int>(i), servidor[i]);
+                                    }
+                                });
+
+        // Cada usuario envía desde su propio hilo, como en el servidor; el mensaje lleva
+        // la hora en que se encoló para medir cuánto espera hasta llegar
+        std::vector<std::thread> remitentes;
+        for (int i = 0; i < numUsuarios; ++i) {
+            remitentes.emplace_back([&, i]() {
+                for (int j = 0; j < mensajesPorUsuario; ++j) {
+                    if (pausaMicrosegundos > 0) {
+                        std::this_thread::sleep_for(std::chrono::microseconds(pausaMicrosegundos));
+                    }
+                    difusor.encolar(std::to_string(i) + ":" + std::to_string(j) + ":" +
+                                    std::to_string(ahoraMicrosegundos()) + "\n", i);
+                }
+            });
+        }
+        for (auto& t : remitentes) {
+            t.join();
+        }
+        difusor.vaciar();
+        lector.join();
+
+        resultado.envios = difusor.obtenerEnviosRealizados();
+        resultado.lotes = difusor.obtenerLotesEnviados();
+    }
+    resultado.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    resultado.ordenCorrecto = ordenCorrecto;
+    resultado.latenciaPromedio = mensajesMedidos > 0 ? static_cast<double>(latenciaTotal) / mensajesMedidos : 0.0;
+    resultado.latenciaMaxima = static_cast<double>(latenciaMaxima);
+
+    for (int i = 0; i < numUsuarios; ++i) {
+        close(servidor[i]);
+        close(cliente[i]);
+    }
+    return resultado;
+}
+
+int main(int argc, char* argv[]) {
+    int numUsuarios, mensajesPorUsuario, limiteBytes, pausa;
+    try {
+        numUsuarios = argc > 1 ? std::stoi(argv[1]) : 32;
+        mensajesPorUsuario = argc > 2 ? std::stoi(argv[2]) : 200;
+        limiteBytes = argc > 3 ? std::stoi(argv[3]) : 4096;
+        pausa = argc > 4 ? std::stoi(argv[4]) : 5000;
+    } catch (const std::exception&) {
+        numUsuarios = 0;  // Fuerza el mensaje de uso
+        mensajesPorUsuario = limiteBytes = pausa = 0;
+    }
+
+    // Con menos de dos usuarios nadie tiene a quién difundir y el lector esperaría en vano
+    if (argc > 5 || numUsuarios < 2 || mensajesPorUsuario < 1 || limiteBytes < 1 || pausa < 0) {
+        std::cerr << "Uso: " << argv[0]
+                  << " [usuarios>=2] [mensajesPorUsuario>=1] [limiteBytesLote>=1] [pausaMicrosegundos>=0]\n";
+        return 1;
+    }
+
+    std::cout << "Usuarios: " << numUsuarios << ", mensajes por usuario: " << mensajesPorUsuario
+              << ", límite de bytes por lote: " << limiteBytes << "\n";
+
+    // La ráfaga muestra la reducción de envíos; el modo pausado, el costo en latencia de cada ventana
+    bool correcto = true;
+    for (int pausaModo : {0, pausa}) {
+        if (pausaModo == 0) {
+            std::cout << "\nModo ráfaga (sin pausa entre mensajes)\n";
+        } else {
+            std::cout << "\nModo pausado (" << pausaModo << " us entre mensajes de cada usuario)\n";
+        }
+        std::cout << "ventana(us)\tenvios\tlotes\ttiempo(s)\tlat. prom(us)\tlat. max(us)\torden\n";
+        for (int ventana : {0, 100, 250, 500}) {
+            Resultado r = ejecutar(ventana, limiteBytes, numUsuarios, mensajesPorUsuario, pausaModo);
+            correcto = correcto && r.ordenCorrecto;
+            std::cout << ventana << "\t\t" << r.envios << "\t" << r.lotes << "\t"
+                      << r.segundos << "\t" << r.latenciaPromedio << "\t\t" << r.latenciaMaxima << "\t\t"
+                      << (r.ordenCorrecto ? "ok" : "ERROR") << "\n";
+        }
+        if (pausa <= 0) {
+            break;
+        }
+    }
+
+    return correcto ? 0 : 1;
+}
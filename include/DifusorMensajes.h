@@ -0,0 +1,66 @@
+#ifndef DIFUSORMENSAJES_H
+#define DIFUSORMENSAJES_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Agrupa los mensajes de difusión que llegan dentro de una ventana de tiempo
+// en lotes de hasta limiteBytes y envía cada lote con un solo send por destinatario.
+// Con una ventana de cero cada mensaje se envía de inmediato, como antes.
+class DifusorMensajes {
+public:
+    // Recibe el id de conexión y el socket de cada destinatario
+    using Destino = std::function<void(int idConexion, int descriptor)>;
+    // Recorre los usuarios conectados; debe mantenerlos bloqueados mientras dura el recorrido
+    // para que ningún socket se cierre (y se reutilice) a mitad del envío
+    using RecorrerDestinatarios = std::function<void(const Destino&)>;
+
+    DifusorMensajes(std::chrono::microseconds ventana, size_t limiteBytes,
+                    RecorrerDestinatarios recorrerDestinatarios);
+    ~DifusorMensajes();
+
+    void encolar(const std::string& mensaje, int idRemitente);
+    void vaciar();  // Envía de inmediato lo que esté pendiente, en lotes de hasta limiteBytes
+
+    size_t obtenerEnviosRealizados() const;  // Llamadas a send realizadas
+    size_t obtenerLotesEnviados() const;  // Lotes despachados
+
+private:
+    struct Pendiente {
+        std::string mensaje;  // Contenido del mensaje
+        int idRemitente;  // Conexión del remitente (no recibe su propio mensaje)
+    };
+
+    void bucleVaciado();
+    void despachar(const std::vector<Pendiente>& lote);
+    void enviarA(int descriptor, const std::string& carga);
+
+    // Múltiplo de limiteBytes que puede acumular la cola antes de bloquear a los remitentes
+    static const size_t lotesEnCola = 4;
+
+    std::chrono::microseconds ventana;  // Tiempo máximo que espera un mensaje antes de enviarse
+    size_t limiteBytes;  // Tamaño máximo de un lote; al alcanzarlo se envía sin agotar la ventana
+    RecorrerDestinatarios recorrerDestinatarios;  // Usuarios conectados al momento del envío
+
+    std::vector<Pendiente> pendientes;  // Mensajes en espera, en orden de llegada
+    size_t bytesPendientes;  // Tamaño acumulado de los mensajes en espera
+    std::chrono::steady_clock::time_point inicioLote;  // Llegada del primer mensaje en espera
+    bool detener;  // Indica al hilo de vaciado que debe terminar
+    std::mutex mutexPendientes;  // Protege la cola de pendientes
+    std::mutex mutexEnvio;  // Serializa los despachos para conservar el orden
+    std::condition_variable condicion;  // Despierta al hilo de vaciado
+    std::condition_variable condicionEspacio;  // Despierta a los remitentes cuando la cola se vacía
+    std::thread hiloVaciado;  // Hilo que despacha los lotes
+
+    std::atomic<size_t> enviosRealizados;
+    std::atomic<size_t> lotesEnviados;
+};
+
+#endif // DIFUSORMENSAJES_H
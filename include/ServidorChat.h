@@ -2,6 +2,7 @@
 #define SERVIDORCHAT_H
 
 #include "Usuario.h"
+#include "DifusorMensajes.h"
 #include <string>
 #include <vector>
 #include <mutex>
@@ -9,15 +10,16 @@
 
 class ServidorChat {
 public:
-    ServidorChat(int puerto);
+    ServidorChat(int puerto, int ventanaLoteMicrosegundos = 0, size_t limiteBytesLote = 4096);
     void iniciar();
 
 private:
     void manejarCliente(int descriptorCliente);
-    void enviarMensajeATodos(const std::string& mensaje, int descriptorRemitente);
+    void enviarMensajeATodos(const std::string& mensaje, int idRemitente);
     void enviarListaUsuarios(int descriptorCliente);
     void enviarDetallesConexion(int descriptorCliente);
     void enviarInformacionMonitor();
+    void recorrerUsuarios(const DifusorMensajes::Destino& destino);
 
     // Nuevas variables para métricas
     void actualizarEstadisticas(const std::chrono::steady_clock::time_point& tiempoMensaje);
@@ -26,7 +28,9 @@ private:
     int puerto;  // Puerto en el que escucha el servidor
     int descriptorServidor;  // Descriptor del socket del servidor
     std::vector<Usuario> usuarios;  // Lista de usuarios conectados
+    int siguienteIdConexion;  // Id que se asignará a la próxima conexión
     std::mutex mutexUsuarios;  // Mutex para proteger el acceso a la lista de usuarios
+    DifusorMensajes difusor;  // Agrupa los mensajes de difusión en lotes (ventana 0 = sin agrupar)
 
     // Variables para calcular métricas
     int totalMensajes;  // Número total de mensajes recibidos
@@ -5,13 +5,15 @@
 
 class Usuario {
 public:
-    Usuario(const std::string& nombreUsuario, int descriptorSocket);
+    Usuario(const std::string& nombreUsuario, int descriptorSocket, int idConexion);
     std::string obtenerNombreUsuario() const;
     int obtenerDescriptorSocket() const;
+    int obtenerIdConexion() const;
 
 private:
     std::string nombreUsuario;  // Nombre del usuario
     int descriptorSocket;      // Descriptor del socket del usuario
+    int idConexion;            // Identificador único de la conexión (no se reutiliza como el descriptor)
 };
 
 #endif // USUARIO_H
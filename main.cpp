@@ -13,11 +13,15 @@ int main(int argc, char* argv[]) {
 
     if (modo == "servidor") {
         if (argc < 3) {
-            std::cerr << "Uso: " << argv[0] << " servidor <puerto>\n";
+            std::cerr << "Uso: " << argv[0] << " servidor <puerto> [ventanaLoteMicrosegundos] [limiteBytesLote]\n";
             return 1;
         }
         int puerto = std::stoi(argv[2]);
-        ServidorChat servidor(puerto);  // Inicializa el servidor con el puerto proporcionado
+        // Ventana de agrupación de mensajes: 0 envía cada mensaje de inmediato (menor latencia),
+        // valores como 100-500 agrupan ráfagas en un solo send por usuario (mayor rendimiento)
+        int ventanaLote = argc > 3 ? std::stoi(argv[3]) : 0;
+        size_t limiteBytesLote = argc > 4 ? std::stoul(argv[4]) : 4096;
+        ServidorChat servidor(puerto, ventanaLote, limiteBytesLote);  // Inicializa el servidor con el puerto y la ventana de agrupación
         servidor.iniciar();  // Inicia el servidor
     } else if (modo == "cliente") {
         if (argc < 4) {
@@ -0,0 +1,170 @@
+#include "DifusorMensajes.h"
+#include <algorithm>
+#include <cerrno>
+#include <iterator>
+#include <sys/socket.h>
+
+// Constructor: si la ventana es mayor que cero se inicia el hilo que despacha los lotes
+DifusorMensajes::DifusorMensajes(std::chrono::microseconds ventana, size_t limiteBytes,
+                                 RecorrerDestinatarios recorrerDestinatarios)
+    : ventana(ventana), limiteBytes(limiteBytes), recorrerDestinatarios(recorrerDestinatarios),
+      bytesPendientes(0), detener(false), enviosRealizados(0), lotesEnviados(0) {
+    if (ventana.count() > 0) {
+        hiloVaciado = std::thread(&DifusorMensajes::bucleVaciado, this);
+    }
+}
+
+// Destructor: detiene el hilo de vaciado y envía lo que haya quedado pendiente
+DifusorMensajes::~DifusorMensajes() {
+    {
+        std::lock_guard<std::mutex> lock(mutexPendientes);
+        detener = true;
+    }
+    condicion.notify_one();
+    condicionEspacio.notify_all();
+    if (hiloVaciado.joinable()) {
+        hiloVaciado.join();
+    }
+    vaciar();
+}
+
+// Agrega un mensaje a la cola; sin ventana se envía directamente. Si la cola está
+// llena el remitente espera a que se vacíe, igual que antes esperaba en send, para
+// que un cliente que no lee frene a quien escribe en lugar de hacer crecer la memoria
+void DifusorMensajes::encolar(const std::string& mensaje, int idRemitente) {
+    if (ventana.count() <= 0) {
+        std::lock_guard<std::mutex> lock(mutexEnvio);
+        despachar({Pendiente{mensaje, idRemitente}});
+        return;
+    }
+
+    bool despertar;
+    {
+        std::unique_lock<std::mutex> lock(mutexPendientes);
+        // Un mensaje mayor que la cola completa se admite cuando la cola está vacía
+        size_t limiteCola = lotesEnCola * limiteBytes;
+        condicionEspacio.wait(lock, [&]() {
+            return detener || bytesPendientes == 0 || bytesPendientes + mensaje.size() <= limiteCola;
+        });
+        // La ventana se cuenta desde la llegada del primer mensaje en espera
+        if (pendientes.empty()) {
+            inicioLote = std::chrono::steady_clock::now();
+        }
+        pendientes.push_back(Pendiente{mensaje, idRemitente});
+        bytesPendientes += mensaje.size();
+        // Se despierta al hilo al abrir un lote nuevo o al alcanzar el límite de bytes
+        despertar = pendientes.size() == 1 || bytesPendientes >= limiteBytes;
+    }
+    if (despertar) {
+        condicion.notify_one();
+    }
+}
+
+// Despacha todos los mensajes pendientes en lotes de a lo sumo limiteBytes
+// (un mensaje más grande que el límite forma un lote por sí solo)
+void DifusorMensajes::vaciar() {
+    std::lock_guard<std::mutex> lockEnvio(mutexEnvio);
+    while (true) {
+        std::vector<Pendiente> lote;
+        {
+            std::lock_guard<std::mutex> lock(mutexPendientes);
+            size_t bytesLote = 0;
+            size_t cantidad = 0;
+            while (cantidad < pendientes.size() &&
+                   (cantidad == 0 || bytesLote + pendientes[cantidad].mensaje.size() <= limiteBytes)) {
+                bytesLote += pendientes[cantidad].mensaje.size();
+                cantidad++;
+            }
+            lote.assign(std::make_move_iterator(pendientes.begin()),
+                        std::make_move_iterator(pendientes.begin() + cantidad));
+            pendientes.erase(pendientes.begin(), pendientes.begin() + cantidad);
+            bytesPendientes -= bytesLote;
+        }
+        if (!lote.empty()) {
+            condicionEspacio.notify_all();
+        }
+        if (lote.empty()) {
+            break;
+        }
+        despachar(lote);
+    }
+}
+
+// Bucle del hilo de vaciado: espera a que se cumpla la ventana del primer mensaje
+// en espera (aunque haya llegado durante el envío anterior) o a que se alcance el
+// límite de bytes
+void DifusorMensajes::bucleVaciado() {
+    std::unique_lock<std::mutex> lock(mutexPendientes);
+    while (!detener) {
+        condicion.wait(lock, [this]() { return detener || !pendientes.empty(); });
+        if (detener) {
+            break;
+        }
+
+        auto cierre = inicioLote + ventana;
+        condicion.wait_until(lock, cierre, [this]() { return detener || bytesPendientes >= limiteBytes; });
+
+        lock.unlock();
+        vaciar();
+        lock.lock();
+    }
+}
+
+// Arma una carga por destinatario con los mensajes del lote, en orden de llegada,
+// omitiendo los que envió el propio destinatario, y la manda con un solo send.
+// Los destinatarios se consultan en el momento del envío y se identifican por su
+// id de conexión, de modo que un descriptor reutilizado no hereda mensajes ajenos
+void DifusorMensajes::despachar(const std::vector<Pendiente>& lote) {
+    std::string cargaCompleta;
+    std::vector<int> remitentes;
+    for (const auto& pendiente : lote) {
+        cargaCompleta += pendiente.mensaje;
+        remitentes.push_back(pendiente.idRemitente);
+    }
+
+    recorrerDestinatarios([&](int idConexion, int descriptor) {
+        if (std::find(remitentes.begin(), remitentes.end(), idConexion) == remitentes.end()) {
+            enviarA(descriptor, cargaCompleta);
+            return;
+        }
+
+        std::string carga;
+        for (const auto& pendiente : lote) {
+            if (pendiente.idRemitente != idConexion) {
+                carga += pendiente.mensaje;
+            }
+        }
+        if (!carga.empty()) {
+            enviarA(descriptor, carga);
+        }
+    });
+    lotesEnviados++;
+}
+
+// Envía la carga completa al socket indicado, repitiendo ante escrituras parciales,
+// y contabiliza cada llamada a send. Se abandona al primer error (p. ej. el cliente
+// se desconectó); MSG_NOSIGNAL evita que eso termine el proceso con SIGPIPE
+void DifusorMensajes::enviarA(int descriptor, const std::string& carga) {
+    size_t enviado = 0;
+    while (enviado < carga.size()) {
+        ssize_t bytes = send(descriptor, carga.c_str() + enviado, carga.size() - enviado, MSG_NOSIGNAL);
+        enviosRealizados++;
+        if (bytes == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        enviado += bytes;
+    }
+}
+
+// Devuelve el número de llamadas a send realizadas
+size_t DifusorMensajes::obtenerEnviosRealizados() const {
+    return enviosRealizados;
+}
+
+// Devuelve el número de lotes despachados
+size_t DifusorMensajes::obtenerLotesEnviados() const {
+    return lotesEnviados;
+}
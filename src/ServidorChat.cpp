@@ -8,8 +8,11 @@
 #include <netinet/in.h>
 
 // Constructor de la clase ServidorChat
-ServidorChat::ServidorChat(int puerto)
-    : puerto(puerto), descriptorServidor(-1), totalMensajes(0), 
+ServidorChat::ServidorChat(int puerto, int ventanaLoteMicrosegundos, size_t limiteBytesLote)
+    : puerto(puerto), descriptorServidor(-1), siguienteIdConexion(0),
+      difusor(std::chrono::microseconds(ventanaLoteMicrosegundos), limiteBytesLote,
+              [this](const DifusorMensajes::Destino& destino) { recorrerUsuarios(destino); }),
+      totalMensajes(0), 
       tiempoUltimoMensaje(std::chrono::steady_clock::now()), 
       tiempoTotal(std::chrono::duration<double>::zero()), 
       totalUsuarios(0), promedioMensajes(0.0), tasaUso(0.0) {}
@@ -93,15 +96,17 @@ void ServidorChat::manejarCliente(int descriptorCliente) {
     nombreUsuario = std::string(buffer, bytesRecibidos);
     nombreUsuario.erase(nombreUsuario.find_last_not_of(" \n\r\t") + 1);
 
+    int idConexion;
     {
         std::lock_guard<std::mutex> lock(mutexUsuarios);
-        usuarios.emplace_back(nombreUsuario, descriptorCliente);
+        idConexion = siguienteIdConexion++;
+        usuarios.emplace_back(nombreUsuario, descriptorCliente, idConexion);
         totalUsuarios = usuarios.size();
     }
 
     // Envía un mensaje de bienvenida a todos los usuarios
     std::string mensajeBienvenida = nombreUsuario + " se ha conectado al chat.\n";
-    enviarMensajeATodos(mensajeBienvenida, descriptorCliente);
+    enviarMensajeATodos(mensajeBienvenida, idConexion);
 
     // Maneja los mensajes del cliente en un bucle
     while (true) {
@@ -109,19 +114,6 @@ void ServidorChat::manejarCliente(int descriptorCliente) {
         bytesRecibidos = recv(descriptorCliente, buffer, 1024, 0);
 
         if (bytesRecibidos <= 0) {
-            {
-                std::lock_guard<std::mutex> lock(mutexUsuarios);
-                for (auto it = usuarios.begin(); it != usuarios.end(); ++it) {
-                    if (it->obtenerDescriptorSocket() == descriptorCliente) {
-                        std::string mensajeDespedida = it->obtenerNombreUsuario() + " se ha desconectado del chat.\n";
-                        enviarMensajeATodos(mensajeDespedida, descriptorCliente);
-                        usuarios.erase(it);
-                        totalUsuarios = usuarios.size();
-                        break;
-                    }
-                }
-            }
-            close(descriptorCliente);
             break;
         }
 
@@ -134,7 +126,6 @@ void ServidorChat::manejarCliente(int descriptorCliente) {
         } else if (mensaje.substr(0, 9) == "@conexion") {
             enviarDetallesConexion(descriptorCliente);
         } else if (mensaje.substr(0, 6) == "@salir") {
-            close(descriptorCliente);
             break;
         } else if (mensaje.substr(0, 2) == "@h") {
             std::string ayuda = "Comandos disponibles:\n"
@@ -144,18 +135,40 @@ void ServidorChat::manejarCliente(int descriptorCliente) {
             send(descriptorCliente, ayuda.c_str(), ayuda.size(), 0);
         } else {
             mensaje = nombreUsuario + ": " + mensaje;
-            enviarMensajeATodos(mensaje, descriptorCliente);
+            enviarMensajeATodos(mensaje, idConexion);
         }
     }
+
+    // Quita al usuario de la lista antes de cerrar su socket, para que el difusor
+    // nunca envíe a un descriptor cerrado o ya reutilizado por otra conexión
+    {
+        std::lock_guard<std::mutex> lock(mutexUsuarios);
+        for (auto it = usuarios.begin(); it != usuarios.end(); ++it) {
+            if (it->obtenerIdConexion() == idConexion) {
+                usuarios.erase(it);
+                totalUsuarios = usuarios.size();
+                break;
+            }
+        }
+    }
+    close(descriptorCliente);
+
+    // Se difunde fuera del bloqueo: el difusor vuelve a tomar mutexUsuarios
+    std::string mensajeDespedida = nombreUsuario + " se ha desconectado del chat.\n";
+    enviarMensajeATodos(mensajeDespedida, idConexion);
 }
 
 // Envía un mensaje a todos los usuarios conectados, excepto al remitente
-void ServidorChat::enviarMensajeATodos(const std::string& mensaje, int descriptorRemitente) {
+void ServidorChat::enviarMensajeATodos(const std::string& mensaje, int idRemitente) {
+    difusor.encolar(mensaje, idRemitente);
+}
+
+// Recorre los usuarios conectados para el difusor; la lista permanece bloqueada
+// durante el envío, así ningún socket se cierra mientras se le escribe
+void ServidorChat::recorrerUsuarios(const DifusorMensajes::Destino& destino) {
     std::lock_guard<std::mutex> lock(mutexUsuarios);
     for (const auto& usuario : usuarios) {
-        if (usuario.obtenerDescriptorSocket() != descriptorRemitente) {
-            send(usuario.obtenerDescriptorSocket(), mensaje.c_str(), mensaje.size(), 0);
-        }
+        destino(usuario.obtenerIdConexion(), usuario.obtenerDescriptorSocket());
     }
 }
 
@@ -1,8 +1,8 @@
 #include "Usuario.h"
 
-// Constructor que inicializa el nombre del usuario y el descriptor del socket
-Usuario::Usuario(const std::string& nombreUsuario, int descriptorSocket)
-    : nombreUsuario(nombreUsuario), descriptorSocket(descriptorSocket) {}
+// Constructor que inicializa el nombre del usuario, el descriptor del socket y el id de la conexión
+Usuario::Usuario(const std::string& nombreUsuario, int descriptorSocket, int idConexion)
+    : nombreUsuario(nombreUsuario), descriptorSocket(descriptorSocket), idConexion(idConexion) {}
 
 // Método para obtener el nombre del usuario
 std::string Usuario::obtenerNombreUsuario() const {
@@ -13,3 +13,8 @@ std::string Usuario::obtenerNombreUsuario() const {
 int Usuario::obtenerDescriptorSocket() const {
     return descriptorSocket;
 }
+
+// Método para obtener el identificador de la conexión
+int Usuario::obtenerIdConexion() const {
+    return idConexion;
+}